@@ -6,6 +6,7 @@
 #include <sstream>
 
 #include "poly.h"
+#include "multipoly.h"
 
 std::optional<double> poly_test(polynomial& p1,
                                 polynomial& p2,
@@ -146,6 +147,266 @@ std::optional<double> test_polynomial_modulo(polynomial& dividend,
     return duration.count();
 }
 
+// Check the power series operations against known series and the full product
+bool test_power_series() {
+    // 1 + x + x^2 + ... + x^2999, dense so the FFT paths are used
+    std::vector<std::pair<power, coeff>> ones;
+    for (power i = 0; i < 3000; i++) {
+        ones.push_back({i, 1});
+    }
+    polynomial f(ones.begin(), ones.end());
+    const size_t n = 2048;
+
+    auto begin = std::chrono::high_resolution_clock::now();
+    polynomial inv = f.inverse_series(n);
+    auto end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> duration = end - begin;
+    std::cout << "Series inverse time: " << duration.count() << " seconds" << std::endl;
+
+    // 1 / (1 + x + x^2 + ...) = 1 - x
+    std::vector<std::pair<power, coeff>> one_minus_x = {{1, -1}, {0, 1}};
+    if (inv.canonical_form() != one_minus_x) {
+        return false;
+    }
+    std::vector<std::pair<power, coeff>> one = {{0, 1}};
+    if (f.mullow(inv, n).canonical_form() != one) {
+        return false;
+    }
+
+    // 1 / (1 - x)^2 and 1 / (1 - x)^3 have growing coefficients k + 1 and
+    // (k + 1)(k + 2) / 2, which the Newton iteration has to get exactly right
+    std::vector<std::pair<power, coeff>> cube = {{3, -1}, {2, 3}, {1, -3}, {0, 1}};
+    std::vector<std::pair<power, coeff>> square = {{2, 1}, {1, -2}, {0, 1}};
+    std::vector<std::pair<power, coeff>> expected_cube, expected_square;
+    for (power k = n; k-- > 0;) {
+        expected_cube.push_back({k, static_cast<coeff>((k + 1) * (k + 2) / 2)});
+        expected_square.push_back({k, static_cast<coeff>(k + 1)});
+    }
+    polynomial c3(cube.begin(), cube.end());
+    polynomial c2(square.begin(), square.end());
+    if (c3.inverse_series(n).canonical_form() != expected_cube
+        || c2.inverse_series(n).canonical_form() != expected_square) {
+        return false;
+    }
+
+    polynomial product = f * f;
+    polynomial low = f.mullow(f, 4000);
+    polynomial high = f.mulhigh(f, 4000);
+    if ((low + high).canonical_form() != product.canonical_form()) {
+        return false;
+    }
+
+    // sqrt(f^2) = f
+    if (product.sqrt_series(3000).canonical_form() != f.canonical_form()) {
+        return false;
+    }
+    if (polynomial().exp_series(n).canonical_form() != one) {
+        return false;
+    }
+
+    // exp(6x) = 1 + 6x + 18x^2 + 36x^3 mod x^4, and log takes it back to 6x
+    std::vector<std::pair<power, coeff>> six_x = {{1, 6}};
+    std::vector<std::pair<power, coeff>> exp_six_x = {{3, 36}, {2, 18}, {1, 6}, {0, 1}};
+    polynomial g(six_x.begin(), six_x.end());
+    polynomial exp_g = g.exp_series(4);
+    if (exp_g.canonical_form() != exp_six_x || exp_g.log_series(4).canonical_form() != six_x) {
+        return false;
+    }
+
+    // exp(2x^2) = 1 + 2x^2 + 2x^4 mod x^6
+    std::vector<std::pair<power, coeff>> two_x2 = {{2, 2}};
+    std::vector<std::pair<power, coeff>> exp_two_x2 = {{4, 2}, {2, 2}, {0, 1}};
+    polynomial h(two_x2.begin(), two_x2.end());
+    if (h.exp_series(6).canonical_form() != exp_two_x2) {
+        return false;
+    }
+
+    // Results that aren't integral throw instead of being rounded
+    std::vector<std::pair<power, coeff>> x = {{1, 1}};
+    std::vector<std::pair<power, coeff>> x_plus_one = {{1, 1}, {0, 1}};
+    std::vector<std::pair<power, coeff>> x_plus_two = {{1, 1}, {0, 2}};
+    polynomial px(x.begin(), x.end());
+    polynomial px1(x_plus_one.begin(), x_plus_one.end());
+    polynomial px2(x_plus_two.begin(), x_plus_two.end());
+    auto throws = [](auto op) {
+        try {
+            op();
+        } catch (const std::runtime_error &) {
+            return true;
+        }
+        return false;
+    };
+    if (!throws([&]() { px.exp_series(6); }) || !throws([&]() { px1.log_series(3); })
+        || !throws([&]() { px2.inverse_series(3); }) || !throws([&]() { px1.sqrt_series(3); })) {
+        return false;
+    }
+
+    // Everything is 0 mod x^0
+    std::vector<std::pair<power, coeff>> zero = {{0, 0}};
+    return px1.inverse_series(0).canonical_form() == zero
+        && px1.log_series(0).canonical_form() == zero
+        && px.exp_series(0).canonical_form() == zero
+        && px1.sqrt_series(0).canonical_form() == zero;
+}
+
+// Check dense (Kronecker) and sparse multivariate products against nested loops
+bool test_multipoly() {
+    // Dense bivariate operands, 40x40 terms each
+    std::vector<std::pair<exponents, coeff>> terms1, terms2;
+    for (power i = 0; i < 40; i++) {
+        for (power j = 0; j < 40; j++) {
+            terms1.push_back({{i, j}, static_cast<coeff>((i + 2 * j) % 7) - 3});
+            terms2.push_back({{i, j}, static_cast<coeff>((3 * i + j) % 5) - 2});
+        }
+    }
+    multipoly a(2, terms1.begin(), terms1.end());
+    multipoly b(2, terms2.begin(), terms2.end());
+
+    auto begin = std::chrono::high_resolution_clock::now();
+    multipoly product = a * b;
+    auto end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> duration = end - begin;
+    std::cout << "Bivariate multiplication time: " << duration.count() << " seconds" << std::endl;
+
+    std::vector<std::pair<exponents, coeff>> naive;
+    for (const auto& [e1, c1] : terms1) {
+        for (const auto& [e2, c2] : terms2) {
+            naive.push_back({{e1[0] + e2[0], e1[1] + e2[1]}, c1 * c2});
+        }
+    }
+    multipoly expected(2, naive.begin(), naive.end());
+    if (product.canonical_form() != expected.canonical_form()) {
+        return false;
+    }
+
+    // Sparse trivariate: (x + y^100 + z^1000) * (x - y^100) = x^2 - y^200 + xz^1000 - y^100z^1000
+    std::vector<std::pair<exponents, coeff>> sparse1 = {{{1, 0, 0}, 1}, {{0, 100, 0}, 1}, {{0, 0, 1000}, 1}};
+    std::vector<std::pair<exponents, coeff>> sparse2 = {{{1, 0, 0}, 1}, {{0, 100, 0}, -1}};
+    multipoly s1(3, sparse1.begin(), sparse1.end());
+    multipoly s2(3, sparse2.begin(), sparse2.end());
+    std::vector<std::pair<exponents, coeff>> sparse_expected = {
+        {{2, 0, 0}, 1}, {{1, 0, 1000}, 1}, {{0, 200, 0}, -1}, {{0, 100, 1000}, -1}
+    };
+    return (s1 * s2).canonical_form() == sparse_expected;
+}
+
+// Horner's rule with the operators, used as the reference for composition
+polynomial horner_compose(const std::vector<std::pair<power, coeff>>& p, const polynomial& q) {
+    polynomial result;
+    power degree = p.front().first;
+    for (power i = degree + 1; i-- > 0;) {
+        coeff c = 0;
+        for (const auto& term : p) {
+            if (term.first == i) c = term.second;
+        }
+        result = result * q + c;
+    }
+    return result;
+}
+
+// Check compose, compose_mod and taylor_shift against Horner's rule
+bool test_composition() {
+    std::vector<std::pair<power, coeff>> outer;
+    for (power i = 12; i + 1 > 0; i--) {
+        outer.push_back({i, static_cast<coeff>((i * 5) % 3) - 1});
+    }
+    outer.front().second = 1;
+    polynomial p(outer.begin(), outer.end());
+
+    // q = x^2 + x + 1
+    std::vector<std::pair<power, coeff>> inner = {{2, 1}, {1, 1}, {0, 1}};
+    polynomial q(inner.begin(), inner.end());
+    if (compose(p, q).canonical_form() != horner_compose(outer, q).canonical_form()) {
+        return false;
+    }
+
+    // q = x^3 + 2, m = x^7 - x + 1
+    std::vector<std::pair<power, coeff>> inner_mod = {{3, 1}, {0, 2}};
+    std::vector<std::pair<power, coeff>> modulus = {{7, 1}, {1, -1}, {0, 1}};
+    polynomial qm(inner_mod.begin(), inner_mod.end());
+    polynomial m(modulus.begin(), modulus.end());
+    polynomial expected = horner_compose(outer, qm) % m;
+    if (compose_mod(p, qm, m).canonical_form() != expected.canonical_form()) {
+        return false;
+    }
+
+    // p(x - 1) is p composed with x - 1
+    std::vector<std::pair<power, coeff>> x_minus_one = {{1, 1}, {0, -1}};
+    polynomial shift(x_minus_one.begin(), x_minus_one.end());
+    auto begin = std::chrono::high_resolution_clock::now();
+    polynomial shifted = taylor_shift(p, -1);
+    auto end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> duration = end - begin;
+    std::cout << "Taylor shift time: " << duration.count() << " seconds" << std::endl;
+    if (shifted.canonical_form() != horner_compose(outer, shift).canonical_form()) {
+        return false;
+    }
+
+    // A modulus of 1 reduces everything to 0, and non-unit leading coefficients throw
+    std::vector<std::pair<power, coeff>> small_outer = {{3, 1}, {1, 2}, {0, 5}};
+    std::vector<std::pair<power, coeff>> x2_plus_one = {{2, 1}, {0, 1}};
+    std::vector<std::pair<power, coeff>> unit = {{0, 1}};
+    std::vector<std::pair<power, coeff>> non_monic = {{2, 2}, {0, 1}};
+    std::vector<std::pair<power, coeff>> zero = {{0, 0}};
+    polynomial sp(small_outer.begin(), small_outer.end());
+    polynomial sq(x2_plus_one.begin(), x2_plus_one.end());
+    polynomial one(unit.begin(), unit.end());
+    polynomial nm(non_monic.begin(), non_monic.end());
+    if (compose_mod(sp, sq, one).canonical_form() != zero) {
+        return false;
+    }
+    try {
+        compose_mod(sp, sq, nm);
+        return false;
+    } catch (const std::runtime_error &) {
+    }
+
+    // Degree 3000 so the block combination runs in parallel
+    std::vector<std::pair<power, coeff>> big_outer, negated, squared;
+    for (power i = 3000; i + 1 > 0; i--) {
+        coeff c = (i == 3000) ? 1 : static_cast<coeff>((i * 5) % 3) - 1;
+        big_outer.push_back({i, c});
+        negated.push_back({i, (i % 2) ? -c : c});
+        squared.push_back({2 * i, c});
+    }
+    polynomial big(big_outer.begin(), big_outer.end());
+    std::vector<std::pair<power, coeff>> minus_x = {{1, -1}};
+    std::vector<std::pair<power, coeff>> x2 = {{2, 1}};
+    polynomial qneg(minus_x.begin(), minus_x.end());
+    polynomial qsq(x2.begin(), x2.end());
+    polynomial expected_neg(negated.begin(), negated.end());
+    polynomial expected_sq(squared.begin(), squared.end());
+    if (compose(big, qneg).canonical_form() != expected_neg.canonical_form()
+        || compose(big, qsq).canonical_form() != expected_sq.canonical_form()) {
+        return false;
+    }
+
+    // p(x^2) mod 1 + x + ... + x^1500, a dense modulus so the reductions use
+    // the FFT. Since x^1501 = 1 mod m, x^e reduces to x^(e mod 1501), and then
+    // x^1500 = -(1 + x + ... + x^1499).
+    const power N = 1500;
+    std::vector<std::pair<power, coeff>> dense_mod;
+    for (power i = 0; i <= N; i++) {
+        dense_mod.push_back({i, 1});
+    }
+    std::vector<coeff> folded(N + 1, 0);
+    for (const auto& [i, c] : big_outer) {
+        folded[(2 * i) % (N + 1)] += c;
+    }
+    std::vector<std::pair<power, coeff>> reduced;
+    for (power i = 0; i < N; i++) {
+        reduced.push_back({i, folded[i] - folded[N]});
+    }
+    polynomial dm(dense_mod.begin(), dense_mod.end());
+    polynomial expected_mod(reduced.begin(), reduced.end());
+    begin = std::chrono::high_resolution_clock::now();
+    polynomial composed = compose_mod(big, qsq, dm);
+    end = std::chrono::high_resolution_clock::now();
+    duration = end - begin;
+    std::cout << "Composition mod time: " << duration.count() << " seconds" << std::endl;
+    return composed.canonical_form() == expected_mod.canonical_form();
+}
+
 int main()
 {
     /** We're doing (x+1)^2, so solution is x^2 + 2x + 1*/
@@ -223,5 +484,23 @@ int main()
     // Call the sparse polynomial test function
     test_sparse_polynomials();
 
+    if (test_power_series()) {
+        std::cout << "Passed power series test" << std::endl;
+    } else {
+        std::cout << "Failed power series test" << std::endl;
+    }
+
+    if (test_multipoly()) {
+        std::cout << "Passed multipoly test" << std::endl;
+    } else {
+        std::cout << "Failed multipoly test" << std::endl;
+    }
+
+    if (test_composition()) {
+        std::cout << "Passed composition test" << std::endl;
+    } else {
+        std::cout << "Failed composition test" << std::endl;
+    }
+
     return 0;
 }
\ No newline at end of file
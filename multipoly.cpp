@@ -0,0 +1,242 @@
+#include "multipoly.h"
+
+multipoly::multipoly(size_t num_vars) : vars(num_vars) {
+    if (num_vars == 0 || num_vars > 64) {
+        throw std::runtime_error("Number of variables must be between 1 and 64");
+    }
+    bits = static_cast<unsigned>(64 / num_vars);
+    polyData[0] = 0;
+}
+
+multipoly::multipoly(const multipoly &other)
+    : vars(other.vars), bits(other.bits), polyData(other.polyData) {}
+
+void multipoly::print() const {
+    auto terms = canonical_form();
+    for (const auto& term : terms) {
+        std::cout << term.second;
+        for (size_t i = 0; i < vars; i++) {
+            std::cout << "x" << i << "^" << term.first[i];
+        }
+        std::cout << " ";
+    }
+    std::cout << std::endl;
+}
+
+multipoly &multipoly::operator=(const multipoly &other) {
+    vars = other.vars;
+    bits = other.bits;
+    polyData = other.polyData;
+    return *this;
+}
+
+multipoly multipoly::operator+(const multipoly &other) const {
+    check_same_vars(other);
+    multipoly result = *this;
+    for (const auto& term : other.polyData) {
+        result.polyData[term.first] += term.second;
+        if (result.polyData[term.first] == 0) {
+            result.polyData.erase(term.first);
+        }
+    }
+    if (result.polyData.empty()) {
+        result.polyData[0] = 0;
+    }
+    return result;
+}
+
+multipoly multipoly::operator-(const multipoly &other) const {
+    check_same_vars(other);
+    multipoly result = *this;
+    for (const auto& term : other.polyData) {
+        result.polyData[term.first] -= term.second;
+        if (result.polyData[term.first] == 0) {
+            result.polyData.erase(term.first);
+        }
+    }
+    if (result.polyData.empty()) {
+        result.polyData[0] = 0;
+    }
+    return result;
+}
+
+multipoly multipoly::operator*(const multipoly &other) const {
+    check_same_vars(other);
+    exponents deg1 = find_degrees_of();
+    exponents deg2 = other.find_degrees_of();
+
+    // Every field of the packed product must still fit in its bits
+    const monomial mask = bits == 64 ? ~monomial(0) : (monomial(1) << bits) - 1;
+    exponents bounds(vars);
+    double dense_size1 = 1, dense_size2 = 1, product_size = 1;
+    for (size_t i = 0; i < vars; i++) {
+        bounds[i] = deg1[i] + deg2[i];
+        if (bounds[i] > mask || bounds[i] < deg1[i]) {
+            throw std::runtime_error("Exponent overflow in packed monomial");
+        }
+        dense_size1 *= deg1[i] + 1;
+        dense_size2 *= deg2[i] + 1;
+        product_size *= bounds[i] + 1;
+    }
+
+    // Same rule as polynomial::operator*: only dense, large operands go through
+    // the FFT, and the Kronecker image must be small enough to allocate
+    double sparsity1 = polyData.size() / dense_size1;
+    double sparsity2 = other.polyData.size() / dense_size2;
+    if (dense_size1 > 1000 && dense_size2 > 1000 && sparsity1 > 0.1 && sparsity2 > 0.1
+        && product_size < (1 << 26)) {
+        return multiply_kronecker(other, bounds);
+    }
+    return multiply_sparse(other);
+}
+
+multipoly multipoly::operator*(int val) const {
+    multipoly result(vars);
+    if (val == 0) {
+        return result;
+    }
+    result.polyData.clear();
+    for (const auto& term : polyData) {
+        result.polyData[term.first] = term.second * val;
+    }
+    return result;
+}
+
+multipoly operator*(int val, const multipoly &other) {
+    return other * val;
+}
+
+size_t multipoly::num_vars() const {
+    return vars;
+}
+
+exponents multipoly::find_degrees_of() const {
+    exponents degrees(vars, 0);
+    for (const auto& term : polyData) {
+        if (term.second == 0) continue;
+        exponents e = unpack(term.first);
+        for (size_t i = 0; i < vars; i++) {
+            degrees[i] = std::max(degrees[i], e[i]);
+        }
+    }
+    return degrees;
+}
+
+std::vector<std::pair<exponents, coeff>> multipoly::canonical_form() const {
+    std::vector<std::pair<monomial, coeff>> terms;
+    terms.reserve(polyData.size());
+    for (const auto& term : polyData) {
+        if (term.second != 0) {
+            terms.emplace_back(term.first, term.second);
+        }
+    }
+    if (terms.empty()) {
+        return {{exponents(vars, 0), 0}};
+    }
+    std::sort(terms.begin(), terms.end(),
+        [](const auto& a, const auto& b) { return a.first > b.first; }
+    );
+
+    std::vector<std::pair<exponents, coeff>> canonical;
+    canonical.reserve(terms.size());
+    for (const auto& term : terms) {
+        canonical.emplace_back(unpack(term.first), term.second);
+    }
+    return canonical;
+}
+
+monomial multipoly::pack(const exponents &e) const {
+    if (e.size() != vars) {
+        throw std::runtime_error("Exponent vector doesn't match the number of variables");
+    }
+    const monomial mask = bits == 64 ? ~monomial(0) : (monomial(1) << bits) - 1;
+    monomial key = 0;
+    for (size_t i = 0; i < vars; i++) {
+        if (e[i] > mask) {
+            throw std::runtime_error("Exponent overflow in packed monomial");
+        }
+        key |= static_cast<monomial>(e[i]) << (bits * (vars - 1 - i));
+    }
+    return key;
+}
+
+exponents multipoly::unpack(monomial key) const {
+    const monomial mask = bits == 64 ? ~monomial(0) : (monomial(1) << bits) - 1;
+    exponents e(vars);
+    for (size_t i = 0; i < vars; i++) {
+        e[i] = static_cast<power>((key >> (bits * (vars - 1 - i))) & mask);
+    }
+    return e;
+}
+
+void multipoly::check_same_vars(const multipoly &other) const {
+    if (vars != other.vars) {
+        throw std::runtime_error("Multipoly operands have different numbers of variables");
+    }
+}
+
+multipoly multipoly::multiply_kronecker(const multipoly &other, const exponents &bounds) const {
+    // Kronecker substitution: x_i -> x^(stride_i), where stride_i is the
+    // product of (bound_j + 1) over the less significant variables j > i.
+    // The bounds are the product degrees, so no two product monomials collide.
+    std::vector<power> stride(vars);
+    power s = 1;
+    for (size_t i = vars; i-- > 0;) {
+        stride[i] = s;
+        s *= bounds[i] + 1;
+    }
+
+    auto substitute = [&](const multipoly &p) {
+        polynomial uni;
+        for (const auto& term : p.polyData) {
+            if (term.second == 0) continue;
+            exponents e = p.unpack(term.first);
+            power k = 0;
+            for (size_t i = 0; i < vars; i++) {
+                k += e[i] * stride[i];
+            }
+            uni.polyData[k] = term.second;
+        }
+        return uni;
+    };
+    polynomial product = substitute(*this).multiply_fft(substitute(other));
+
+    multipoly result(vars);
+    result.polyData.clear();
+    exponents e(vars);
+    for (const auto& term : product.polyData) {
+        if (term.second == 0) continue;
+        power k = term.first;
+        for (size_t i = 0; i < vars; i++) {
+            e[i] = k / stride[i];
+            k %= stride[i];
+        }
+        result.polyData[pack(e)] = term.second;
+    }
+    if (result.polyData.empty()) {
+        result.polyData[0] = 0;
+    }
+    return result;
+}
+
+multipoly multipoly::multiply_sparse(const multipoly &other) const {
+    // The exponent fields can't carry into each other (checked by operator*),
+    // so adding the packed keys multiplies the monomials
+    multipoly result(vars);
+    result.polyData.clear();
+    for (const auto& term1 : polyData) {
+        if (term1.second == 0) continue;
+        for (const auto& term2 : other.polyData) {
+            if (term2.second == 0) continue;
+            monomial key = term1.first + term2.first;
+            result.polyData[key] += term1.second * term2.second;
+            if (result.polyData[key] == 0) {
+                result.polyData.erase(key);
+            }
+        }
+    }
+    if (result.polyData.empty()) {
+        result.polyData[0] = 0;
+    }
+    return result;
+}
@@ -0,0 +1,147 @@
+#ifndef MULTIPOLY_H
+#define MULTIPOLY_H
+
+#include <cstdint>
+#include <vector>
+#include <utility>
+#include <unordered_map>
+
+#include "poly.h"
+
+using monomial = uint64_t;
+using exponents = std::vector<power>;
+
+class multipoly
+{
+
+public:
+    /**
+     * @brief Construct a new multipoly object in num_vars variables that is the
+     *        number 0
+     *
+     *        Each monomial is packed into a single 64-bit key, with 64 / num_vars
+     *        bits per variable. Variable 0 lives in the most significant bits, so
+     *        comparing keys compares monomials in lexicographic order.
+     *
+     * @param num_vars
+     *  The number of variables, between 1 and 64
+     */
+    explicit multipoly(size_t num_vars);
+
+    /**
+     * @brief Construct a new multipoly object from an iterator to pairs of
+     *        <exponents,coeff>
+     *
+     * @tparam Iter
+     *  An iterator that points to a std::pair<exponents, coeff>
+     * @param num_vars
+     *  The number of variables, between 1 and 64
+     * @param begin
+     *  The start of the container to copy elements from
+     * @param end
+     *  The end of the container to copy elements from
+     */
+    template <typename Iter>
+    multipoly(size_t num_vars, Iter begin, Iter end) : multipoly(num_vars) {
+        for (; begin != end; ++begin) {
+            if (begin->second == 0) continue;
+            monomial key = pack(begin->first);
+            polyData[key] += begin->second;
+            if (polyData[key] == 0) {
+                polyData.erase(key);
+            }
+        }
+        if (polyData.empty()) {
+            polyData[0] = 0;
+        }
+    }
+
+    /**
+     * @brief Construct a new multipoly object from an existing multipoly object
+     *
+     * @param other
+     *  The multipoly to copy
+     */
+    multipoly(const multipoly &other);
+
+    /**
+     * @brief Prints the multipoly.
+     *
+     * Only used for debugging.
+     *
+     */
+    void print() const;
+
+    /**
+     * @brief Turn the current multipoly instance into a deep copy of another
+     * multipoly
+     *
+     * @param other
+     * The multipoly to copy
+     * @return
+     * A reference to the copied multipoly
+     */
+    multipoly &operator=(const multipoly &other);
+
+    /**
+     * Both operands of a binary operator must have the same number of
+     * variables, otherwise a std::runtime_error is thrown.
+     *
+     * Multiplication maps dense operands onto the univariate polynomial
+     * multiplication with Kronecker substitution, and multiplies sparse
+     * operands directly on the packed monomials with a hash map.
+     */
+    multipoly operator+(const multipoly &other) const;
+    multipoly operator-(const multipoly &other) const;
+    multipoly operator*(const multipoly &other) const;
+    multipoly operator*(int val) const;
+    friend multipoly operator*(int val, const multipoly &other);
+
+    /**
+     * @brief Returns the number of variables
+     *
+     * @return size_t
+     *  The number of variables
+     */
+    size_t num_vars() const;
+
+    /**
+     * @brief Returns the largest exponent of each variable
+     *
+     * @return exponents
+     *  The degree of the multipoly in each variable
+     */
+    exponents find_degrees_of() const;
+
+    /**
+     * @brief Returns a vector that contains the multipoly in canonical form. The
+     *        terms are sorted in descending lexicographic order of their
+     *        exponents, and terms with a coefficient of zero aren't returned.
+     *
+     *        ie. x^2 + 3xy^2 + 1 would be returned as
+     *        [([2,0],1),([1,2],3),([0,0],1)]
+     *
+     *        The only exception is the multipoly 0, which is returned as a single
+     *        entry of [([0,...,0],0)]
+     *
+     * @return std::vector<std::pair<exponents, coeff>>
+     *  A vector of pairs representing the canonical form of the multipoly
+     */
+    std::vector<std::pair<exponents, coeff>> canonical_form() const;
+
+private:
+    size_t vars;
+    unsigned bits;
+    std::unordered_map<monomial, coeff> polyData;
+
+    // Packed monomial helpers
+    monomial pack(const exponents &e) const;
+    exponents unpack(monomial key) const;
+    void check_same_vars(const multipoly &other) const;
+
+    // Multiplication strategies
+    multipoly multiply_kronecker(const multipoly &other, const exponents &bounds) const;
+    multipoly multiply_sparse(const multipoly &other) const;
+};
+
+#endif
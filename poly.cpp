@@ -311,3 +311,448 @@ polynomial polynomial::multiply_fft(const polynomial& other) const {
     }
     return result;
 }
+
+polynomial polynomial::mullow(const polynomial &other, size_t n) const {
+    polynomial result;
+    if (n == 0) {
+        return result;
+    }
+
+    size_t len1 = std::min(find_degree_of() + 1, n);
+    size_t len2 = std::min(other.find_degree_of() + 1, n);
+    size_t terms1 = 0, terms2 = 0;
+    for (const auto& term : polyData) {
+        if (term.first < n && term.second != 0) ++terms1;
+    }
+    for (const auto& term : other.polyData) {
+        if (term.first < n && term.second != 0) ++terms2;
+    }
+
+    // Same density rule as operator*, applied to the truncated inputs
+    double sparsity1 = terms1 / static_cast<double>(len1);
+    double sparsity2 = terms2 / static_cast<double>(len2);
+    if (len1 > 1000 && len2 > 1000 && sparsity1 > 0.1 && sparsity2 > 0.1) {
+        return from_dense(multiply_dense(to_dense(len1), other.to_dense(len2), n));
+    }
+
+    for (const auto& term1 : polyData) {
+        if (term1.first >= n) continue;
+        for (const auto& term2 : other.polyData) {
+            power new_power = term1.first + term2.first;
+            if (new_power >= n) continue;
+            result.polyData[new_power] += term1.second * term2.second;
+            if (result.polyData[new_power] == 0) {
+                result.polyData.erase(new_power);
+            }
+        }
+    }
+    if (result.polyData.empty()) {
+        result.polyData[0] = 0;
+    }
+    return result;
+}
+
+polynomial polynomial::mulhigh(const polynomial &other, size_t n) const {
+    size_t deg1 = find_degree_of();
+    size_t deg2 = other.find_degree_of();
+    if (n > deg1 + deg2) {
+        return polynomial();
+    }
+
+    // The high part of a*b is the reversed low part of rev(a)*rev(b)
+    size_t len = deg1 + deg2 + 1 - n;
+    polynomial rev1, rev2;
+    for (const auto& [pow, c] : polyData) {
+        if (deg1 - pow < len && c != 0) rev1.polyData[deg1 - pow] = c;
+    }
+    for (const auto& [pow, c] : other.polyData) {
+        if (deg2 - pow < len && c != 0) rev2.polyData[deg2 - pow] = c;
+    }
+    polynomial low = rev1.mullow(rev2, len);
+
+    polynomial result;
+    result.polyData.clear();
+    for (const auto& [pow, c] : low.polyData) {
+        if (c != 0) result.polyData[deg1 + deg2 - pow] = c;
+    }
+    if (result.polyData.empty()) {
+        result.polyData[0] = 0;
+    }
+    return result;
+}
+
+polynomial polynomial::inverse_series(size_t n) const {
+    auto it = polyData.find(0);
+    if (it == polyData.end() || (it->second != 1 && it->second != -1)) {
+        throw std::runtime_error("Series inverse requires a constant term of 1 or -1");
+    }
+    if (n == 0) {
+        return polynomial();
+    }
+    std::vector<double> result = series_inverse(to_dense(n), n);
+    check_integral(result, "Series inverse");
+    return from_dense(result);
+}
+
+polynomial polynomial::log_series(size_t n) const {
+    auto it = polyData.find(0);
+    if (it == polyData.end() || it->second != 1) {
+        throw std::runtime_error("Series log requires a constant term of 1");
+    }
+    if (n == 0) {
+        return polynomial();
+    }
+    std::vector<double> result = series_log(to_dense(n), n);
+    check_integral(result, "Series log");
+    return from_dense(result);
+}
+
+polynomial polynomial::exp_series(size_t n) const {
+    auto it = polyData.find(0);
+    if (it != polyData.end() && it->second != 0) {
+        throw std::runtime_error("Series exp requires a constant term of 0");
+    }
+    if (n == 0) {
+        return polynomial();
+    }
+    std::vector<double> result = series_exp(to_dense(n), n);
+    check_integral(result, "Series exp");
+    return from_dense(result);
+}
+
+polynomial polynomial::sqrt_series(size_t n) const {
+    auto it = polyData.find(0);
+    long long c0 = (it != polyData.end()) ? it->second : 0;
+    long long root = std::llround(std::sqrt(static_cast<double>(std::max(c0, 0LL))));
+    if (c0 <= 0 || root * root != c0) {
+        throw std::runtime_error("Series sqrt requires a perfect square constant term");
+    }
+    if (n == 0) {
+        return polynomial();
+    }
+    std::vector<double> result = series_sqrt(to_dense(n), n);
+    check_integral(result, "Series sqrt");
+    return from_dense(result);
+}
+
+std::vector<double> polynomial::to_dense(size_t n) const {
+    std::vector<double> dense(n, 0.0);
+    for (const auto& [pow, c] : polyData) {
+        if (pow < n) dense[pow] = static_cast<double>(c);
+    }
+    return dense;
+}
+
+polynomial polynomial::from_dense(const std::vector<double> &a) {
+    polynomial result;
+    result.polyData.clear();
+    for (size_t i = 0; i < a.size(); i++) {
+        coeff rounded = static_cast<coeff>(std::llround(a[i]));
+        if (rounded != 0) {
+            result.polyData[i] = rounded;
+        }
+    }
+    if (result.polyData.empty()) {
+        result.polyData[0] = 0;
+    }
+    return result;
+}
+
+void polynomial::check_integral(const std::vector<double> &a, const char *op) {
+    // The series are computed in floating point, so allow for FFT rounding error
+    for (double c : a) {
+        if (!std::isfinite(c) || std::abs(c - std::round(c)) > 1e-3
+            || std::abs(c) > std::numeric_limits<coeff>::max()) {
+            throw std::runtime_error(std::string(op) + " result doesn't have integer coefficients");
+        }
+    }
+}
+
+void polynomial::round_iterate(std::vector<double> &g) {
+    // The public series functions only succeed when the result has integer
+    // coefficients, and then so does every truncation of it. Rounding the
+    // intermediate Newton iterates is exact in that case. Otherwise the next
+    // step still recovers the true, non-integer coefficients below the
+    // rounded ones, and check_integral rejects the final result.
+    for (auto& c : g) {
+        c = std::round(c);
+    }
+}
+
+std::vector<double> polynomial::multiply_dense(const std::vector<double> &a, const std::vector<double> &b, size_t n) {
+    std::vector<double> result(n, 0.0);
+    size_t la = std::min(a.size(), n);
+    size_t lb = std::min(b.size(), n);
+    if (la == 0 || lb == 0) {
+        return result;
+    }
+
+    if (la < 64 || lb < 64) { // Threshold for FFT
+        for (size_t i = 0; i < la; i++) {
+            if (a[i] == 0) continue;
+            for (size_t j = 0; j < lb && i + j < n; j++) {
+                result[i + j] += a[i] * b[j];
+            }
+        }
+        return result;
+    }
+
+    // Only the low n terms are needed, but the transform must still be long
+    // enough that the discarded high terms don't wrap around onto them
+    size_t size = next_power_of_two(la + lb - 1);
+    std::vector<std::complex<double>> fa(size, 0), fb(size, 0);
+    for (size_t i = 0; i < la; i++) fa[i] = a[i];
+    for (size_t i = 0; i < lb; i++) fb[i] = b[i];
+
+    fft(fa);
+    fft(fb);
+    for (size_t i = 0; i < size; i++) {
+        fa[i] *= fb[i];
+    }
+    fft(fa, true);
+
+    size_t len = std::min(n, la + lb - 1);
+    for (size_t i = 0; i < len; i++) {
+        result[i] = fa[i].real();
+    }
+    return result;
+}
+
+std::vector<double> polynomial::series_inverse(const std::vector<double> &a, size_t n) {
+    if (n == 0) {
+        return {};
+    }
+
+    // Newton iteration: g <- g * (2 - a * g), doubling the precision each step.
+    // The callers only pass integer coefficients, so with a unit constant term
+    // every iterate is an integer series, and rounding after each step keeps
+    // the FFT error from being fed back into the next one.
+    const bool integral = std::abs(a[0]) == 1.0;
+    std::vector<double> g{1.0 / a[0]};
+    for (size_t len = 1; len < n;) {
+        len = std::min(2 * len, n);
+        std::vector<double> e = multiply_dense(a, g, len);
+        for (auto& c : e) c = integral ? -std::round(c) : -c;
+        e[0] += 2.0;
+        g = multiply_dense(g, e, len);
+        if (integral) {
+            for (auto& c : g) c = std::round(c);
+        }
+    }
+    g.resize(n, 0.0);
+    return g;
+}
+
+std::vector<double> polynomial::series_log(const std::vector<double> &a, size_t n) {
+    // log(a) = integral(a' / a)
+    std::vector<double> result(n, 0.0);
+    if (n <= 1) {
+        return result;
+    }
+    std::vector<double> deriv(n - 1, 0.0);
+    for (size_t i = 1; i < std::min(a.size(), n); i++) {
+        deriv[i - 1] = a[i] * static_cast<double>(i);
+    }
+    std::vector<double> quotient = multiply_dense(deriv, series_inverse(a, n - 1), n - 1);
+    for (size_t i = 1; i < n; i++) {
+        result[i] = quotient[i - 1] / static_cast<double>(i);
+    }
+    return result;
+}
+
+std::vector<double> polynomial::series_exp(const std::vector<double> &a, size_t n) {
+    // Newton iteration: g <- g * (1 + a - log(g))
+    std::vector<double> g{1.0};
+    for (size_t len = 1; len < n;) {
+        len = std::min(2 * len, n);
+        std::vector<double> h = series_log(g, len);
+        for (size_t i = 0; i < len; i++) {
+            h[i] = (i < a.size() ? a[i] : 0.0) - h[i];
+        }
+        h[0] += 1.0;
+        g = multiply_dense(g, h, len);
+        if (len < n) {
+            round_iterate(g);
+        }
+    }
+    g.resize(n, 0.0);
+    return g;
+}
+
+std::vector<double> polynomial::series_sqrt(const std::vector<double> &a, size_t n) {
+    if (n == 0) {
+        return {};
+    }
+
+    // Newton iteration: g <- (g + a / g) / 2
+    std::vector<double> g{std::sqrt(a[0])};
+    for (size_t len = 1; len < n;) {
+        len = std::min(2 * len, n);
+        std::vector<double> q = multiply_dense(a, series_inverse(g, len), len);
+        g.resize(len, 0.0);
+        for (size_t i = 0; i < len; i++) {
+            g[i] = (g[i] + q[i]) / 2;
+        }
+        if (len < n) {
+            round_iterate(g);
+        }
+    }
+    g.resize(n, 0.0);
+    return g;
+}
+
+polynomial compose(const polynomial &p, const polynomial &q) {
+    return polynomial::brent_kung(p, q, [](const polynomial &a) { return a; });
+}
+
+polynomial compose_mod(const polynomial &p, const polynomial &q, const polynomial &m) {
+    const size_t dm = m.find_degree_of();
+    const auto lead = m.polyData.find(dm);
+    if (lead == m.polyData.end() || lead->second == 0) {
+        throw std::runtime_error("Division by zero polynomial");
+    }
+    if (lead->second != 1 && lead->second != -1) {
+        throw std::runtime_error("Composition modulus requires a leading coefficient of 1 or -1");
+    }
+    if (dm == 0) {
+        return polynomial();
+    }
+
+    // With a unit leading coefficient the quotient is exact over the integers,
+    // so it can be read off rev(a) * rev(m)^-1 mod x^k
+    const polynomial rev_inv = polynomial::reverse(m, dm).inverse_series(dm);
+    auto reduce = [&m, &rev_inv, dm](const polynomial &a) -> polynomial {
+        const size_t da = a.find_degree_of();
+        if (da < dm) return a;
+        const size_t k = da - dm + 1;
+        if (k > dm) return a % m;
+
+        polynomial quotient = polynomial::reverse(polynomial::reverse(a, da).mullow(rev_inv, k), k - 1);
+        polynomial low;
+        for (const auto& [pow, c] : a.polyData) {
+            if (pow < dm && c != 0) low.polyData[pow] = c;
+        }
+        return low - quotient.mullow(m, dm);
+    };
+    return polynomial::brent_kung(p, reduce(q), reduce);
+}
+
+polynomial taylor_shift(const polynomial &p, coeff a) {
+    const size_t d = p.find_degree_of();
+    if (d == 0 || a == 0) {
+        return p;
+    }
+
+    const size_t n = polynomial::next_power_of_two(d + 1);
+    std::vector<coeff> c(n, 0);
+    for (const auto& [pow, coef] : p.polyData) {
+        c[pow] = coef;
+    }
+
+    // shifts[i] = (x + a)^(2^i)
+    std::vector<polynomial> shifts;
+    polynomial s;
+    s.polyData[0] = a;
+    s.polyData[1] = 1;
+    // The recursion needs powers up to (x + a)^(n/2), so stop before squaring
+    // that into an unused (x + a)^n
+    shifts.push_back(s);
+    for (size_t len = 1; 2 * len < n; len *= 2) {
+        s = s * s;
+        shifts.push_back(s);
+    }
+    return polynomial::taylor_shift_rec(c, 0, n, shifts);
+}
+
+polynomial polynomial::reverse(const polynomial &p, size_t n) {
+    polynomial result;
+    for (const auto& [pow, c] : p.polyData) {
+        if (pow <= n && c != 0) result.polyData[n - pow] = c;
+    }
+    return result;
+}
+
+polynomial polynomial::brent_kung(const polynomial &p, const polynomial &q,
+                                  const std::function<polynomial(const polynomial &)> &reduce) {
+    const size_t d = p.find_degree_of();
+    if (d == 0) {
+        return p;
+    }
+    const size_t k = static_cast<size_t>(std::ceil(std::sqrt(static_cast<double>(d + 1))));
+    const size_t blocks = (d + k) / k;
+
+    // Baby steps q^0 ... q^(k-1), and the giant step q^k
+    std::vector<polynomial> baby(k);
+    baby[0].polyData[0] = 1;
+    for (size_t i = 1; i < k; i++) {
+        baby[i] = reduce(baby[i - 1] * q);
+    }
+    const polynomial giant = reduce(baby[k - 1] * q);
+
+    // Block j is sum_i p[j*k + i] * q^i, a linear combination of the baby
+    // steps that doesn't depend on any other block
+    std::vector<polynomial> block(blocks);
+    auto combine = [&](size_t first, size_t step) {
+        for (size_t j = first; j < blocks; j += step) {
+            auto& data = block[j].polyData;
+            for (size_t i = 0; i < k; i++) {
+                auto it = p.polyData.find(j * k + i);
+                if (it == p.polyData.end() || it->second == 0) continue;
+                for (const auto& term : baby[i].polyData) {
+                    data[term.first] += it->second * term.second;
+                }
+            }
+            for (auto it = data.begin(); it != data.end();) {
+                it = (it->second == 0) ? data.erase(it) : std::next(it);
+            }
+            if (data.empty()) {
+                data[0] = 0;
+            }
+        }
+    };
+    if (d > 1000) { // Threshold for multithreading
+        size_t num_threads = std::max<size_t>(1, std::min(blocks, static_cast<size_t>(std::thread::hardware_concurrency())));
+        std::vector<std::thread> threads;
+        for (size_t t = 0; t < num_threads; ++t) {
+            threads.emplace_back(combine, t, num_threads);
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    } else {
+        combine(0, 1);
+    }
+
+    // Giant steps: Horner's rule in q^k over the blocks
+    polynomial result = block[blocks - 1];
+    for (size_t j = blocks - 1; j-- > 0;) {
+        result = reduce(result * giant) + block[j];
+    }
+    if (result.polyData.empty()) {
+        result.polyData[0] = 0;
+    }
+    return result;
+}
+
+polynomial polynomial::taylor_shift_rec(const std::vector<coeff> &c, size_t lo, size_t len,
+                                        const std::vector<polynomial> &shifts) {
+    if (len == 1) {
+        polynomial result;
+        result.polyData[0] = c[lo];
+        return result;
+    }
+
+    // p(x + a) = p_low(x + a) + (x + a)^half * p_high(x + a)
+    const size_t half = len / 2;
+    const size_t level = static_cast<size_t>(std::log2(half));
+    polynomial low, high;
+    if (len > 2048) { // Threshold for multithreading
+        std::thread thread_low([&]() { low = taylor_shift_rec(c, lo, half, shifts); });
+        high = taylor_shift_rec(c, lo + half, half, shifts);
+        thread_low.join();
+    } else {
+        low = taylor_shift_rec(c, lo, half, shifts);
+        high = taylor_shift_rec(c, lo + half, half, shifts);
+    }
+    return low + shifts[level] * high;
+}
@@ -10,6 +10,10 @@
 #include <thread>
 #include <mutex>
 #include <cmath>
+#include <stdexcept>
+#include <limits>
+#include <string>
+#include <functional>
 
 using power = size_t;
 using coeff = int;
@@ -128,7 +132,144 @@ public:
     polynomial operator-(const polynomial &other) const;
 
     polynomial operator%(const polynomial &other) const;
-    
+
+    /**
+     * @brief Returns the product of this polynomial and another, truncated to
+     *        the terms of power less than n (ie. the product mod x^n)
+     *
+     * @param other
+     *  The polynomial to multiply by
+     * @param n
+     *  The truncation length
+     * @return polynomial
+     *  The truncated product
+     */
+    polynomial mullow(const polynomial &other, size_t n) const;
+
+    /**
+     * @brief Returns the terms of power n and above of the product of this
+     *        polynomial and another. The terms keep their original powers.
+     *
+     * @param other
+     *  The polynomial to multiply by
+     * @param n
+     *  The lowest power to keep
+     * @return polynomial
+     *  The high part of the product
+     */
+    polynomial mulhigh(const polynomial &other, size_t n) const;
+
+    /**
+     * @brief Returns the multiplicative inverse of this polynomial as a power
+     *        series mod x^n, computed with Newton iteration in O(M(n))
+     *
+     *        The constant term must be 1 or -1, so that the inverse has integer
+     *        coefficients. Otherwise a std::runtime_error is thrown, as it is
+     *        when the coefficients grow too large for the floating point FFT
+     *        to compute exactly.
+     *
+     * @param n
+     *  The truncation length
+     * @return polynomial
+     *  The inverse mod x^n, or 0 when n is 0
+     */
+    polynomial inverse_series(size_t n) const;
+
+    /**
+     * @brief Returns the logarithm of this polynomial as a power series mod x^n,
+     *        computed as the integral of p' / p in O(M(n))
+     *
+     *        The constant term must be 1. The logarithm rarely has integer
+     *        coefficients (ie. log(1 + x) = x - x^2/2 + ...), so a
+     *        std::runtime_error is thrown when any coefficient of the result
+     *        mod x^n isn't an integer.
+     *
+     * @param n
+     *  The truncation length
+     * @return polynomial
+     *  The logarithm mod x^n, or 0 when n is 0
+     */
+    polynomial log_series(size_t n) const;
+
+    /**
+     * @brief Returns the exponential of this polynomial as a power series mod
+     *        x^n, computed with Newton iteration in O(M(n))
+     *
+     *        The constant term must be 0. As with log_series, a
+     *        std::runtime_error is thrown when any coefficient of the result
+     *        mod x^n isn't an integer (ie. exp(2x) mod x^3 = 1 + 2x + 2x^2 is
+     *        accepted, exp(x) mod x^3 isn't).
+     *
+     * @param n
+     *  The truncation length
+     * @return polynomial
+     *  The exponential mod x^n, or 0 when n is 0
+     */
+    polynomial exp_series(size_t n) const;
+
+    /**
+     * @brief Returns the square root of this polynomial as a power series mod
+     *        x^n, computed with Newton iteration in O(M(n))
+     *
+     *        The constant term must be a positive perfect square, and a
+     *        std::runtime_error is thrown when any coefficient of the result
+     *        mod x^n isn't an integer.
+     *
+     * @param n
+     *  The truncation length
+     * @return polynomial
+     *  The square root mod x^n with a positive constant term, or 0 when n is 0
+     */
+    polynomial sqrt_series(size_t n) const;
+
+    /**
+     * @brief Returns the composition p(q(x)), using Brent-Kung baby-step /
+     *        giant-step evaluation. The baby-step blocks are combined in
+     *        parallel for large p.
+     *
+     * @param p
+     *  The outer polynomial
+     * @param q
+     *  The inner polynomial
+     * @return polynomial
+     *  The composition p(q(x))
+     */
+    friend polynomial compose(const polynomial &p, const polynomial &q);
+
+    /**
+     * @brief Returns the composition p(q(x)) % m, reducing every intermediate
+     *        power of q mod m. The reductions use a precomputed series inverse
+     *        of the reversed m instead of long division.
+     *
+     *        The leading coefficient of m must be 1 or -1, so that the
+     *        remainder has integer coefficients. Otherwise a std::runtime_error
+     *        is thrown. A constant modulus of 1 or -1 gives 0.
+     *
+     * @param p
+     *  The outer polynomial
+     * @param q
+     *  The inner polynomial
+     * @param m
+     *  The modulus
+     * @return polynomial
+     *  The composition p(q(x)) % m
+     */
+    friend polynomial compose_mod(const polynomial &p, const polynomial &q, const polynomial &m);
+
+    /**
+     * @brief Returns the Taylor shift p(x + a). The shift is split in halves,
+     *        p_low(x + a) + (x + a)^k * p_high(x + a), so that the work is done
+     *        by a few large multiplications, and the halves run in parallel.
+     *
+     * @param p
+     *  The polynomial to shift
+     * @param a
+     *  The shift
+     * @return polynomial
+     *  The polynomial p(x + a)
+     */
+    friend polynomial taylor_shift(const polynomial &p, coeff a);
+
 
     /**
      * @brief Returns the degree of the polynomial
@@ -161,6 +302,9 @@ public:
     std::vector<std::pair<power, coeff>> canonical_form() const;
 
 private:
+    // multipoly maps its products onto multiply_fft via Kronecker substitution
+    friend class multipoly;
+
     std::unordered_map<power, coeff> polyData;
     mutable std::mutex mutex_;
     
@@ -168,6 +312,24 @@ private:
     static void fft(std::vector<std::complex<double>> &a, bool inverse = false);
     polynomial multiply_fft(const polynomial &other) const;
     static size_t next_power_of_two(size_t n);
+
+    // Dense power series helpers
+    std::vector<double> to_dense(size_t n) const;
+    static polynomial from_dense(const std::vector<double> &a);
+    static void check_integral(const std::vector<double> &a, const char *op);
+    static void round_iterate(std::vector<double> &g);
+    static std::vector<double> multiply_dense(const std::vector<double> &a, const std::vector<double> &b, size_t n);
+    static std::vector<double> series_inverse(const std::vector<double> &a, size_t n);
+    static std::vector<double> series_log(const std::vector<double> &a, size_t n);
+    static std::vector<double> series_exp(const std::vector<double> &a, size_t n);
+    static std::vector<double> series_sqrt(const std::vector<double> &a, size_t n);
+
+    // Composition helpers
+    static polynomial reverse(const polynomial &p, size_t n);
+    static polynomial brent_kung(const polynomial &p, const polynomial &q,
+                                 const std::function<polynomial(const polynomial &)> &reduce);
+    static polynomial taylor_shift_rec(const std::vector<coeff> &c, size_t lo, size_t len,
+                                       const std::vector<polynomial> &shifts);
 };
 
 #endif